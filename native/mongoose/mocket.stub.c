@@ -94,13 +94,17 @@ static const char *gen_id(struct mg_connection *c) {
   return buf;
 }
 
-static void register_client(struct mg_connection *c) {
+// open 事件的 payload 为 "<port> <uri>"，供 MoonBit 侧解析 WS 路由
+static void register_client(struct mg_connection *c, int port, struct mg_http_message *hm) {
   if (WS_CLIENT_COUNT >= MAX_WS_CLIENTS) return;
   const char *id = gen_id(c);
   ws_client_t *slot = &WS_CLIENTS[WS_CLIENT_COUNT++];
   slot->c = c;
   snprintf(slot->id, sizeof(slot->id), "%s", id);
-  if (WS_EMIT_CB) WS_EMIT_CB(cstr_to_moonbit_bytes("open"), cstr_to_moonbit_bytes(slot->id), moonbit_empty_int8_array);
+  char target[2048];
+  snprintf(target, sizeof(target), "%d %.*s", port,
+           hm ? (int) hm->uri.len : 1, hm ? hm->uri.buf : "/");
+  if (WS_EMIT_CB) WS_EMIT_CB(cstr_to_moonbit_bytes("open"), cstr_to_moonbit_bytes(slot->id), cstr_to_moonbit_bytes(target));
 }
 
 static void unregister_client(ws_client_t *cl) {
@@ -299,6 +303,18 @@ void res_end_bytes(response_t *res, uint8_t *body, int32_t body_len)
   }
 }
 
+// 写出完整响应：响应头（状态行、Date、headers 均已编码）+ body
+MOONBIT_FFI_EXPORT
+void res_send(response_t *res, uint8_t *head, int32_t head_len, uint8_t *body, int32_t body_len)
+{
+  if (head && head_len > 0) {
+    mg_send(res->c, head, (size_t) head_len);
+  }
+  if (body && body_len > 0) {
+    mg_send(res->c, body, (size_t) body_len);
+  }
+}
+
 // =================== FFI Functions for MoonBit ===================
 
 // Get request method
@@ -486,7 +502,7 @@ static void ev_handler(struct mg_connection *c, int ev, void *ev_data)
   }
   else if (ev == MG_EV_WS_OPEN)
   {
-    register_client(c);
+    register_client(c, srv->port, (struct mg_http_message *) ev_data);
   }
   else if (ev == MG_EV_WS_MSG)
   {
@@ -516,6 +532,22 @@ static void ev_handler(struct mg_connection *c, int ev, void *ev_data)
   }
 }
 
+// =================== 每秒定时回调 ===================
+
+typedef void (*tick_cb_t)(void);
+
+static void tick_timer(void *arg)
+{
+  ((tick_cb_t) arg)();
+}
+
+// 注册每秒调用一次的回调（在事件循环中执行）
+MOONBIT_FFI_EXPORT
+void server_set_tick(server_t *srv, tick_cb_t cb)
+{
+  mg_timer_add(&srv->mgr, 1000, MG_TIMER_REPEAT | MG_TIMER_RUN_NOW, tick_timer, (void *) cb);
+}
+
 // 创建 server
 MOONBIT_FFI_EXPORT
 server_t *create_server(request_handler_t handler)